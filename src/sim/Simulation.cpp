@@ -7,6 +7,7 @@
 
 #include "renderer/renderer.hpp"
 #include "sphSolver.hpp"
+#include "adaptiveResolution.hpp"
 #include "kernel.hpp"
 #include "simConfig.hpp"
 
@@ -129,6 +130,11 @@ void Simulation::stepSimulation(){
     computeDensityAndPressure(config);
     computeForces(config);
     integrate(config);
+
+    if(config.adaptiveResolution && ++config.adaptStepCounter >= config.ADAPT_INTERVAL){
+        adaptResolution(config);
+        config.adaptStepCounter = 0;
+    }
 }
 
 void Simulation::render(){
@@ -145,7 +151,7 @@ void Simulation::render(){
 
     for (const auto& p : config.particles) {
         positions.push_back(p.position);
-        radii.push_back(config.radius);
+        radii.push_back(config.radius * config.LEVEL_SCALE[p.level]);
         pressures.push_back(-p.p);
 
         config.minPressure = std::min(config.minPressure, -p.p);
@@ -192,6 +198,12 @@ void Simulation::renderUI(){
             initSPH(config);
         }
 
+        // Merge calm interior particles, split them back near the surface
+        if(ImGui::Checkbox("Adaptive Resolution", &config.adaptiveResolution)) {
+            if(!config.adaptiveResolution) refineAll(config);
+            config.adaptStepCounter = 0;
+        }
+
         // Color mode Selection
         if(ImGui::Combo("Color Mode", &config.colorMode, "Jet\0Heat\0BlueRed\0")) {
             // Update colors based on selected mode
@@ -214,6 +226,7 @@ void Simulation::resetSimulation(){
     config.simStepsThisSecond = 0;
     config.simFPSTimer = 0.0;
     config.accumulatedTime = 0.0;
+    config.adaptStepCounter = 0;
 }
 
 void Simulation::throwIfWindowNull(){
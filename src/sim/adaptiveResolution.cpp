@@ -0,0 +1,132 @@
+#include <adaptiveResolution.hpp>
+
+#include <cstdlib>
+#include <glm/glm.hpp>
+
+namespace{
+    // Replaces a particle by two half mass children placed symmetrically about it, so mass, momentum and center of mass are kept
+    void split(const simConfig &config, const Particle &parent, std::vector<Particle> &out){
+        int childLevel = parent.level - 1;
+
+        // Spread the children across the flow, or in a random direction if the parent is at rest
+        glm::vec2 dir;
+        float speed = glm::length(parent.velocity);
+        if (speed > config.EPSILON){
+            dir = glm::vec2(-parent.velocity.y, parent.velocity.x) / speed;
+        } else {
+            float angle = rand() / (float)RAND_MAX * 2.0f * static_cast<float>(M_PI);
+            dir = glm::vec2(cos(angle), sin(angle));
+        }
+        glm::vec2 offset = dir * config.radius * config.LEVEL_SCALE[childLevel]; // half the child spacing
+
+        for (float side : {-1.0f, 1.0f}){
+            glm::vec2 pos = parent.position + side * offset;
+            out.emplace_back(pos.x, pos.y);
+            Particle &child = out.back();
+            child.velocity = parent.velocity;
+            child.rho = parent.rho;
+            child.p = parent.p;
+            child.m = parent.m * 0.5f;
+            child.level = childLevel;
+        }
+    }
+
+    // Combines two particles at their center of mass with their total mass and momentum
+    Particle merge(const Particle &a, const Particle &b){
+        float m = a.m + b.m;
+        glm::vec2 pos = (a.m * a.position + b.m * b.position) / m;
+
+        Particle merged(pos.x, pos.y);
+        merged.velocity = (a.m * a.velocity + b.m * b.velocity) / m;
+        merged.rho = (a.m * a.rho + b.m * b.rho) / m;
+        merged.p = (a.m * a.p + b.m * b.p) / m;
+        merged.m = m;
+        merged.level = a.level + 1;
+        return merged;
+    }
+}
+
+void adaptResolution(simConfig &config){
+    std::vector<Particle> &particles = config.particles;
+    const int n = static_cast<int>(particles.size());
+
+    std::vector<bool> splitting(n, false);
+    std::vector<bool> calm(n, false);
+    std::vector<int> nearest(n, -1); // closest particle of the same level within merge range
+
+    // Classify every particle from its neighborhood within twice its smoothing radius
+    for (int i = 0; i < n; ++i){
+        const Particle &pi = particles[i];
+        float h = config.PAIR_KERNELS[pi.level][pi.level].h;
+        float probeR2 = 4.0f * h * h;
+        float nearestR2 = h * h;
+
+        glm::vec2 offset = glm::vec2(0.0f, 0.0f);
+        float relativeSpeed = 0.0f;
+        float weight = pi.m; // self contribution, w(0) = 1
+
+        for (int j = 0; j < n; ++j){
+            if (i == j) continue;
+            const Particle &pj = particles[j];
+
+            glm::vec2 rij = pj.position - pi.position;
+            float r2 = glm::dot(rij, rij);
+            if (r2 >= probeR2) continue;
+
+            float w = pj.m * (1.0f - r2 / probeR2);
+            offset += w * rij;
+            relativeSpeed += w * glm::length(pj.velocity - pi.velocity);
+            weight += w;
+
+            if (pj.level == pi.level && r2 < nearestR2){
+                nearestR2 = r2;
+                nearest[i] = j;
+            }
+        }
+
+        // Distance from the particle to its neighborhood's center of mass, ~0 when surrounded by fluid
+        float surface = glm::length(offset) / (weight * 2.0f * h);
+        // Relative drift of the neighborhood over one adapt interval, in smoothing radii
+        float shear = relativeSpeed / weight * config.simTime * config.ADAPT_INTERVAL / h;
+
+        if (pi.level > 0 && (surface > config.SPLIT_MIN_SURFACE || shear > config.SPLIT_MIN_SHEAR)){
+            splitting[i] = true;
+        } else if (pi.level < NUM_RESOLUTION_LEVELS - 1 && surface < config.MERGE_MAX_SURFACE && shear < config.MERGE_MAX_SHEAR){
+            calm[i] = true;
+        }
+    }
+
+    // Pair calm particles greedily with their nearest calm neighbor of the same level
+    std::vector<int> partner(n, -1);
+    for (int i = 0; i < n; ++i){
+        int j = nearest[i];
+        if (!calm[i] || partner[i] != -1 || j == -1 || !calm[j] || partner[j] != -1) continue;
+        partner[i] = j;
+        partner[j] = i;
+    }
+
+    std::vector<Particle> adapted;
+    adapted.reserve(n);
+    for (int i = 0; i < n; ++i){
+        if (splitting[i]){
+            split(config, particles[i], adapted);
+        } else if (partner[i] == -1){
+            adapted.push_back(particles[i]);
+        } else if (i < partner[i]){
+            adapted.push_back(merge(particles[i], particles[partner[i]]));
+        }
+    }
+    particles.swap(adapted);
+}
+
+void refineAll(simConfig &config){
+    for (int level = NUM_RESOLUTION_LEVELS - 1; level > 0; --level){
+        std::vector<Particle> refined;
+        refined.reserve(config.particles.size() * 2);
+        for (const auto &p : config.particles){
+            if (p.level == level) split(config, p, refined);
+            else refined.push_back(p);
+        }
+        config.particles.swap(refined);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "simConfig.hpp"
+
+// Merges calm interior particles into heavier ones and splits them back near the free surface or in high shear
+void adaptResolution(simConfig &config);
+// Splits every merged particle back to level 0
+void refineAll(simConfig &config);
\ No newline at end of file
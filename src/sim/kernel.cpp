@@ -2,4 +2,23 @@
 
 float poly6(float H) {return 4.f / (M_PI * pow(H, 8.f));}
 float spikyGradient(float H) {return -10.f / (M_PI * pow(H, 5.f));}
-float viscosityLaplacian(float H) {return 40.f / (M_PI * pow(H, 5.f));}
\ No newline at end of file
+float viscosityLaplacian(float H) {return 40.f / (M_PI * pow(H, 5.f));}
+
+KernelConstants kernelConstants(float H) {return {H, H * H, poly6(H), spikyGradient(H), viscosityLaplacian(H)};}
+
+// Smoothing radius grows with sqrt(mass) so every level keeps roughly the same neighbor count in 2D
+LevelScaleTable levelScales() {
+    LevelScaleTable scales;
+    for (int level = 0; level < NUM_RESOLUTION_LEVELS; ++level) scales[level] = pow(2.f, level * 0.5f);
+    return scales;
+}
+
+// Pairs of different levels interact through the mean of their smoothing radii, which keeps W_ij symmetric
+PairKernelTable pairKernels(float H) {
+    LevelScaleTable scales = levelScales();
+    PairKernelTable table;
+    for (int i = 0; i < NUM_RESOLUTION_LEVELS; ++i)
+        for (int j = 0; j < NUM_RESOLUTION_LEVELS; ++j)
+            table[i][j] = kernelConstants(0.5f * H * (scales[i] + scales[j]));
+    return table;
+}
\ No newline at end of file
@@ -1,6 +1,22 @@
 #pragma once
 #include <cmath>
+#include <array>
 
 float poly6(float H);
 float spikyGradient(float H);
-float viscosityLaplacian(float H);
\ No newline at end of file
+float viscosityLaplacian(float H);
+
+// Adaptive resolution: a level L particle carries the mass of 2^L level 0 particles
+constexpr int NUM_RESOLUTION_LEVELS = 4;
+
+// Kernel constants for one smoothing radius
+struct KernelConstants{
+    float h, h2, poly6, spikyGradient, viscosityLaplacian;
+};
+
+using LevelScaleTable = std::array<float, NUM_RESOLUTION_LEVELS>;
+using PairKernelTable = std::array<std::array<KernelConstants, NUM_RESOLUTION_LEVELS>, NUM_RESOLUTION_LEVELS>;
+
+KernelConstants kernelConstants(float H);
+LevelScaleTable levelScales();
+PairKernelTable pairKernels(float H);
\ No newline at end of file
@@ -20,6 +20,7 @@ struct simConfig{
     float GAS_CONSTANT = 2000.f; // const for equation of state
     float VISCOSITY = 200.0f;
     float G = 9.81f;
+    float PARTICLE_MASS = 2.5f; // mass of a level 0 particle
 
     // Controls
     bool simRunning = false;
@@ -27,11 +28,14 @@ struct simConfig{
     int numParticles = 400;
     int colorMode = 0;
     float radius = H/2;
+    bool adaptiveResolution = false;
 
     // Precomputed kernel constants
     float POLY6 = poly6(H);
     float SPIKY_GRADIENT = spikyGradient(H);
     float VISCOSITY_LAPLACIAN = viscosityLaplacian(H);
+    LevelScaleTable LEVEL_SCALE = levelScales(); // radius and smoothing length multiplier per level
+    PairKernelTable PAIR_KERNELS = pairKernels(H); // kernel constants indexed by [level i][level j]
 
     // Sim parameters
     float EPSILON = H / 100000000;
@@ -40,6 +44,16 @@ struct simConfig{
     float minPressure = std::numeric_limits<float>::max();
     float maxPressure = std::numeric_limits<float>::lowest();
 
+    // Adaptive resolution parameters
+    // Surface: offset of the neighborhood's center of mass within 2h, in units of 2h (~0 inside, ~0.3 at the free surface)
+    // Shear: mean relative neighbor drift over one adapt interval, in smoothing radii
+    int ADAPT_INTERVAL = 10; // steps between split/merge passes
+    int adaptStepCounter = 0;
+    float MERGE_MAX_SURFACE = 0.05f;
+    float MERGE_MAX_SHEAR = 0.02f;
+    float SPLIT_MIN_SURFACE = 0.15f;
+    float SPLIT_MIN_SHEAR = 0.5f;
+
     // Make fps independent from simulation speed
     float simFPS = 60; // target FPS for simulation
     float simDeltaTime = 1 / simFPS; // fixed timestep for simulation
@@ -32,87 +32,113 @@ void initSPH(simConfig &config) {
             );
 
             config.particles.emplace_back(pos.x, pos.y);
+            config.particles.back().m = config.PARTICLE_MASS;
             ++count;
         }
     }
 }
 
-void computeDensityAndPressure(simConfig &config) {
-    for (auto &pi : config.particles){
-        pi.rho = 0.0f; // Reset density
-        for (auto &pj : config.particles){
-            // Calculate distance from pi to pj
-            glm::vec2 rij = pj.position - pi.position;
-            float r2 = glm::dot(rij, rij); // dot product with self == squared norm
-
-            // Only particles within the kernel smoothing radius contribute to density
-            if (r2 < config.H2){
-                pi.rho += pj.m *config.POLY6 * pow(config.H2 - r2, 3);
+namespace{
+    // Without adaptive resolution every particle is level 0, so the scalar constants replace the per pair table lookup
+    template <bool Adaptive>
+    void densityAndPressure(simConfig &config) {
+        const KernelConstants base = {config.H, config.H2, config.POLY6, config.SPIKY_GRADIENT, config.VISCOSITY_LAPLACIAN};
+
+        for (auto &pi : config.particles){
+            const auto &row = config.PAIR_KERNELS[pi.level];
+            pi.rho = 0.0f; // Reset density
+            for (auto &pj : config.particles){
+                // Calculate distance from pi to pj
+                glm::vec2 rij = pj.position - pi.position;
+                float r2 = glm::dot(rij, rij); // dot product with self == squared norm
+                const KernelConstants &k = Adaptive ? row[pj.level] : base;
+
+                // Only particles within the kernel smoothing radius contribute to density
+                if (r2 < k.h2){
+                    pi.rho += pj.m * k.poly6 * pow(k.h2 - r2, 3);
+                }
             }
+            pi.p = config.GAS_CONSTANT * (pi.rho - config.REST_DENSITY); // Pressure based on density
         }
-        pi.p = config.GAS_CONSTANT * (pi.rho - config.REST_DENSITY); // Pressure based on density
     }
-}
 
-void computeForces(simConfig &config){
-    
-    for (auto &pi : config.particles){
-        glm::vec2 pForce = glm::vec2(0.0f, 0.0f);
-        glm::vec2 vForce = glm::vec2(0.0f, 0.0f);
+    template <bool Adaptive>
+    void forces(simConfig &config){
+        const KernelConstants base = {config.H, config.H2, config.POLY6, config.SPIKY_GRADIENT, config.VISCOSITY_LAPLACIAN};
 
-        for(auto &pj : config.particles){
-            if (&pi == &pj) continue; // Skip self
+        for (auto &pi : config.particles){
+            const auto &row = config.PAIR_KERNELS[pi.level];
+            glm::vec2 pForce = glm::vec2(0.0f, 0.0f);
+            glm::vec2 vForce = glm::vec2(0.0f, 0.0f);
 
-            glm::vec2 rij = pj.position - pi.position;
-            float r2 = glm::dot(rij, rij); // dot product with self == squared norm
-            float r = sqrt(r2);
+            for(auto &pj : config.particles){
+                if (&pi == &pj) continue; // Skip self
 
-            if (r < config.H) {
-                // Pressure force
-                glm::vec2 normalizedRij = rij / r; // Normalize the vector
-                pForce += pi.m * (pi.p + pj.p) / (2.0f * pj.rho) * static_cast<float>(config.SPIKY_GRADIENT * pow(config.H - r, 3)) * -normalizedRij;
+                glm::vec2 rij = pj.position - pi.position;
+                float r2 = glm::dot(rij, rij); // dot product with self == squared norm
+                float r = sqrt(r2);
+                const KernelConstants &k = Adaptive ? row[pj.level] : base;
 
-                // Viscosity force
-                vForce += config.VISCOSITY * pj.m / pj.rho * (pj.velocity - pi.velocity) * static_cast<float>(config.VISCOSITY_LAPLACIAN * (config.H - r));
+                if (r < k.h) {
+                    // Pressure force, masses are all equal without adaptive resolution so pi.m stays loop invariant
+                    float mj = Adaptive ? pj.m : pi.m;
+                    glm::vec2 normalizedRij = rij / r; // Normalize the vector
+                    pForce += mj * (pi.p + pj.p) / (2.0f * pj.rho) * static_cast<float>(k.spikyGradient * pow(k.h - r, 3)) * -normalizedRij;
+
+                    // Viscosity force
+                    vForce += config.VISCOSITY * pj.m / pj.rho * (pj.velocity - pi.velocity) * static_cast<float>(k.viscosityLaplacian * (k.h - r));
+                }
             }
-        }
-        // Gravity force
-        glm::vec2 gForce = glm::vec2(0.0f, -config.G * pi.m / pi.rho);
+            // Gravity force, uses the base mass so merged particles fall like the ones they replaced
+            glm::vec2 gForce = glm::vec2(0.0f, -config.G * config.PARTICLE_MASS / pi.rho);
 
-        // Combine forces
-        pi.force = pForce + vForce + gForce;
+            // Combine forces
+            pi.force = pForce + vForce + gForce;
+        }
     }
 }
 
+void computeDensityAndPressure(simConfig &config) {
+    if (config.adaptiveResolution) densityAndPressure<true>(config);
+    else densityAndPressure<false>(config);
+}
+
+void computeForces(simConfig &config){
+    if (config.adaptiveResolution) forces<true>(config);
+    else forces<false>(config);
+}
+
 void integrate(simConfig &config) {
-    float boundaryStiffness = 100.0f;
+    float boundaryStiffness = 100.0f; // wall damping uses the base mass so merged particles are not damped harder
     for(auto &p : config.particles){
+        float radius = config.radius * config.LEVEL_SCALE[p.level];
+
         // Enforce boundary conditions
         // Left
-        if (p.position.x - config.radius - config.EPSILON < 0)
+        if (p.position.x - radius - config.EPSILON < 0)
         {
             p.velocity.x *= -config.BOUND_DAMPING;
-            p.position.x = config.EPSILON + config.radius;
-            p.force.x += -(p.position.x - config.radius) * boundaryStiffness - p.velocity.x * p.m;
+            p.position.x = config.EPSILON + radius;
+            p.force.x += -(p.position.x - radius) * boundaryStiffness - p.velocity.x * config.PARTICLE_MASS;
         }
         // Right
-        if (p.position.x + config.radius + config.EPSILON > config.windowWidth)
+        if (p.position.x + radius + config.EPSILON > config.windowWidth)
         {
             p.velocity.x *= -config.BOUND_DAMPING;
-            p.position.x = config.windowWidth - config.EPSILON - config.radius;
-            p.force.x -= (config.windowWidth - p.position.x - config.radius) * boundaryStiffness - p.velocity.x * p.m;
+            p.position.x = config.windowWidth - config.EPSILON - radius;
+            p.force.x -= (config.windowWidth - p.position.x - radius) * boundaryStiffness - p.velocity.x * config.PARTICLE_MASS;
         }
         // Bottom
-        if (p.position.y - config.radius - config.EPSILON < 0)
+        if (p.position.y - radius - config.EPSILON < 0)
         {
             p.velocity.y *= -config.BOUND_DAMPING;
-            p.position.y = config.EPSILON + config.radius;
+            p.position.y = config.EPSILON + radius;
         }
         // Top
-        if (p.position.y + config.radius + config.EPSILON > config.windowHeight)
+        if (p.position.y + radius + config.EPSILON > config.windowHeight)
         {
             p.velocity.y *= -config.BOUND_DAMPING;
-            p.position.y = config.windowHeight - config.EPSILON - config.radius;
+            p.position.y = config.windowHeight - config.EPSILON - radius;
         }
 
         // Euler integration